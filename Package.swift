@@ -8,6 +8,7 @@ import PackageDescription
 // environment variable `SWIFT_TRACY_ENABLE`
 let enableTracy = Context.environment["SWIFT_TRACY_ENABLE"].isSet
 let enableCUDA = Context.environment["SWIFT_TRACY_CUDA_ENABLE"].isSet
+let enableCapture = Context.environment["SWIFT_TRACY_CAPTURE_ENABLE"].isSet
 let libraryType = Context.environment["BUILD_STATIC_LIBRARIES"].isSet ? Product.Library.LibraryType.static : nil
 
 var packageDependencies: [Package.Dependency] = [.package(url: "https://github.com/swiftlang/swift-syntax.git", from: "600.0.0")]
@@ -31,6 +32,7 @@ else {
         "tracy-client.cpp",
         "tracy-demangle.cpp",
         "tracy-interpose.c",
+        "tracy-concurrency.c",
     ]
     cSettings += [
         .unsafeFlags([
@@ -88,6 +90,53 @@ else if enableTracy {
     print("Tracy CUDA profiling is DISABLED. Enable it through the SWIFT_TRACY_CUDA_ENABLE environment variable.")
 }
 
+// Offline capture embeds the Tracy server (and its zstd dependency) into the
+// client, so that traces can be written directly to disk. This is a fair chunk
+// of extra code, so is only compiled in when requested. The server is built as
+// its own target, the same way upstream builds it: as C++20, and without
+// TRACY_ENABLE. The client is built on demand, so that it accepts a new
+// connection for each segment of the capture, and only listens on localhost.
+var captureTargets: [Target] = []
+var cxxLanguageStandard = CXXLanguageStandard.cxx17
+
+if enableCapture, enableTracy {
+    targetDependencies += ["TracyCapture"]
+    cSettings += [
+        .define("TRACY_OFFLINE_CAPTURE"),
+        .define("TRACY_ON_DEMAND"),
+        .define("TRACY_ONLY_LOCALHOST"),
+    ]
+    cxxSettings += [
+        .define("TRACY_OFFLINE_CAPTURE"),
+        .define("TRACY_ON_DEMAND"),
+        .define("TRACY_ONLY_LOCALHOST"),
+    ]
+    cxxLanguageStandard = .cxx20
+    captureTargets += [
+        .target(
+            name: "TracyCapture",
+            dependencies: ["capstone"],
+            path: "Sources/tracy-cbits",
+            sources: [
+                "tracy-capture.cpp",
+                "tracy/public/common/tracy_lz4hc.cpp",
+                "tracy/zstd/common",
+                "tracy/zstd/compress",
+                "tracy/zstd/decompress",
+                "tracy/zstd/dictBuilder",
+            ],
+            cSettings: [
+                .define("ZSTD_DISABLE_ASM"),
+            ],
+            cxxSettings: [
+                .define("TRACY_OFFLINE_CAPTURE"),
+                .define("TRACY_NO_STATISTICS"),
+                .define("NO_PARALLEL_SORT"),
+            ]
+        ),
+    ]
+}
+
 let package = Package(
     name: "swift-tracy",
     platforms: [.macOS(.v10_15)],
@@ -152,9 +201,23 @@ let package = Package(
             path: "Tests/TracyInterpositionTests",
             swiftSettings: swiftSettings
         ),
-    ],
+        .testTarget(
+            name: "TracyTests",
+            dependencies: ["Tracy"],
+            path: "Tests/TracyTests",
+            swiftSettings: swiftSettings
+        ),
+        .testTarget(
+            name: "TracyMacrosTests",
+            dependencies: [
+                "TracyMacros",
+                .product(name: "SwiftSyntaxMacrosGenericTestSupport", package: "swift-syntax"),
+            ],
+            path: "Tests/TracyMacrosTests"
+        ),
+    ] + captureTargets,
     cLanguageStandard: .c11,
-    cxxLanguageStandard: .cxx17
+    cxxLanguageStandard: cxxLanguageStandard
 )
 
 private extension String? {
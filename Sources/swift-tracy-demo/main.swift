@@ -53,6 +53,11 @@
 //               You should see a rising staircase of buffer sizes, then a
 //               single free when ARC releases the object at the end of the
 //               call. This validates end-to-end Swift ↔ Tracy integration.
+//               Two more pools, "scratch arena" and "entity pool", track the
+//               custom allocators used by poolWorkload: the arena's scratch
+//               region is freed and handed out again at the same address
+//               every frame, while the entity pool shows objects being
+//               acquired and recycled.
 //
 // ─── Building without Tracy ───────────────────────────────────────────────────
 //
@@ -77,7 +82,8 @@ Panels to watch:
   Timeline    — nested zones per frame
   Frame graph — ~60 fps driven by Frame() marks
   Messages    — per-frame log entries
-  Memory      — malloc/realloc/free events (tests interposition)
+  Memory      — malloc/realloc/free events (tests interposition) and
+                named pools for the custom allocators
 
 Press Ctrl-C to stop.
 """)
@@ -86,6 +92,8 @@ Press Ctrl-C to stop.
 // Simulates a simple game-style loop: physics + render at ~60 fps.
 
 var frameIndex: UInt64 = 0
+let scratch = Arena(MemoryPool("scratch arena"))
+let entities = ObjectPool<Entity>(MemoryPool("entity pool"), slabCapacity: 32)
 
 while true {
     // frame() marks the boundary between continuous frames and drives the
@@ -102,6 +110,7 @@ while true {
     simulationStep(frame: frameIndex)
     renderFrame(frame: frameIndex)
     memoryWorkload()
+    poolWorkload(frame: frameIndex, arena: scratch, entities: entities)
 
     // ~60 fps
     Thread.sleep(forTimeInterval: 1.0 / 60.0)
@@ -284,3 +293,38 @@ func memoryWorkload() {
     }
     // ARC releases `buf` here, freeing the array buffer then the class object.
 }
+
+// Custom allocators report to their own named pools, which appear separately
+// from the default (malloc) pool in the Tracy memory panel.
+
+struct Entity {
+    var position: SIMD4<Float>
+    var velocity: SIMD4<Float>
+}
+
+func poolWorkload(frame: UInt64, arena: Arena, entities: ObjectPool<Entity>) {
+    let z = #Zone
+    defer { z.end() }
+
+    // Per-frame scratch space: the arena is rewound every frame, so after the
+    // first few frames no new chunks are reserved.
+    arena.reset()
+    let count = 1024 + Int(frame % 4096)
+    let scratch = arena.allocate(Float.self, capacity: count)
+    for i in 0 ..< count {
+        scratch[i] = Float(i)
+    }
+
+    // A varying number of entities are spawned and despawned each frame, so the
+    // entity pool is repeatedly recycling the same storage.
+    var live: [UnsafeMutablePointer<Entity>] = []
+    for i in 0 ..< 16 + Int(frame % 48) {
+        let e = entities.acquire()
+        e.initialize(to: Entity(position: SIMD4(repeating: Float(i)), velocity: .zero))
+        live.append(e)
+    }
+    for e in live {
+        e.deinitialize(count: 1)
+        entities.release(e)
+    }
+}
@@ -0,0 +1,410 @@
+// Copyright (c) 2026 The swift-tracy authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Interoperability layer to produce Tracy profiler traces from Swift
+//
+// This module provides an offline capture mode, where the trace is written
+// directly to .tracy files on local disk instead of requiring a separate
+// tracy-capture or profiler process to connect to the client.
+//
+// The client only knows how to stream its events to a server, and it is the
+// server which resolves strings, source locations, etc. (by querying the
+// client for them while it is connected) and produces the capture file. So,
+// rather than reimplement that here, we run the same server-side Worker that
+// tracy-capture uses on a dedicated thread inside the process, connected to the
+// client over the loopback interface only.
+//
+// The capture is split into segments, each of which is collected by its own
+// Worker. Once a segment reaches the configured size or duration the Worker
+// disconnects, and is handed over to a writer thread which compresses and
+// writes it out (as large sequential zstd blocks) while the next Worker is
+// already collecting the following segment. The client is built with
+// TRACY_ON_DEMAND, so it accepts the new connection, and does not buffer any
+// events in the short gap between segments. At most two segments are held in
+// memory at once: the one being collected and the one being written. If the
+// writer falls behind, the next segment does not start until it catches up,
+// and the events in between are dropped.
+//
+// A segment is written to a temporary file which is renamed once complete, so
+// if the process is killed only the segment in progress is lost, and no
+// partially written trace is left behind under the final name.
+//
+// The capture is configured through the following environment variables:
+//
+//   SWIFT_TRACY_CAPTURE_FILE             output path; enables offline capture.
+//                                        Any '%p' is replaced with the process
+//                                        ID, and '%n' with the segment number.
+//                                        If there is no '%n', the segment
+//                                        number is inserted before the
+//                                        extension.
+//   SWIFT_TRACY_CAPTURE_ROTATE_MB        start a new segment once the current
+//                                        one uses this much memory in the
+//                                        capture (default 1024). The written
+//                                        file is compressed, and much smaller.
+//   SWIFT_TRACY_CAPTURE_ROTATE_SECONDS   also start a new segment after this
+//                                        many seconds (default 0; disabled)
+//
+// Unless TRACY_PORT is set explicitly, the client is pinned to a free port
+// chosen at startup. This is done through the environment, which is restored as
+// soon as the profiler has read it (see tracy-init.cpp), so that it is not
+// inherited by child processes. Between choosing the port and the client
+// listening on it another process could claim it, so the capture checks that
+// the client it connected to is this process, and gives up otherwise.
+//
+// Since the Worker is not aware that it is running inside the profiled
+// process, its threads are excluded from the malloc interposition, otherwise
+// its own allocations would be reported back into the trace it is recording.
+//
+// The server sources need C++20 and must not see TRACY_ENABLE, so this is
+// built as a separate target (see Package.swift), and links against the
+// client's copy of the common sources (sockets, lz4, etc.).
+
+#ifdef TRACY_OFFLINE_CAPTURE
+
+// The server sources are compiled as part of this translation unit so that
+// their static initialisers are guaranteed to have run before
+// ___tracy_capture_start below.
+#include "tracy/server/TracyMemory.cpp"
+#include "tracy/server/TracyMmap.cpp"
+#include "tracy/server/TracyPrint.cpp"
+#include "tracy/server/TracyTaskDispatch.cpp"
+#include "tracy/server/TracyTextureCompression.cpp"
+#include "tracy/server/TracyThreadCompress.cpp"
+#include "tracy/server/TracyWorker.cpp"
+
+#include "tracy/server/TracyFileWrite.hpp"
+#include "tracy/server/TracyMemory.hpp"
+#include "tracy/server/TracyWorker.hpp"
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <errno.h>
+#include <mutex>
+#include <netinet/in.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+extern "C" void ___tracy_interpose_suppress_thread(void);
+
+struct ___tracy_capture_config
+{
+  std::string path;
+  uint16_t port;
+  int64_t rotate_bytes;
+  int64_t rotate_seconds;
+};
+
+struct ___tracy_capture_segment
+{
+  tracy::Worker* worker;
+  std::string path;
+  int64_t bytes;
+};
+
+// Deliberately pointers, so that they are constant initialised and can be set
+// from ___tracy_auto_process_init, which runs before regular static
+// constructors.
+static ___tracy_capture_config* ___tracy_capture_pending = nullptr;
+static std::thread* ___tracy_capture_thread = nullptr;
+static std::atomic<bool> ___tracy_capture_shutdown { false };
+
+// Whether we set TRACY_PORT, and must remove it once the profiler has read it
+static bool ___tracy_capture_set_port = false;
+
+// The single slot between the capture thread and the writer thread
+static std::mutex ___tracy_capture_mutex;
+static std::condition_variable ___tracy_capture_cv;
+static ___tracy_capture_segment* ___tracy_capture_writing = nullptr;
+static bool ___tracy_capture_done = false;
+
+// Memory used by the segment currently being written, which must not be
+// counted against the segment being collected.
+static std::atomic<int64_t> ___tracy_capture_writing_bytes { 0 };
+
+// Ask the OS for a currently unused loopback port for the client to listen on.
+static uint16_t ___tracy_capture_reserve_port()
+{
+  int fd = socket( AF_INET, SOCK_STREAM, 0 );
+  if ( fd < 0 )
+    return 0;
+
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+  addr.sin_port = 0;
+
+  uint16_t port = 0;
+  socklen_t len = sizeof( addr );
+  if ( bind( fd, (sockaddr*)&addr, sizeof( addr ) ) == 0 && getsockname( fd, (sockaddr*)&addr, &len ) == 0 )
+    port = ntohs( addr.sin_port );
+
+  close( fd );
+  return port;
+}
+
+// Parse a non-negative integer setting, returning false if it is malformed.
+static bool ___tracy_capture_parse( const char* name, int64_t* value )
+{
+  const char* str = getenv( name );
+  if ( !str )
+    return true;
+
+  char* end = nullptr;
+  errno = 0;
+  const long long result = strtoll( str, &end, 10 );
+  if ( errno != 0 || end == str || *end != '\0' || result < 0 ) {
+    fprintf( stderr, "tracy: invalid value '%s' for %s; offline capture disabled\n", str, name );
+    return false;
+  }
+
+  *value = result;
+  return true;
+}
+
+static void ___tracy_capture_replace( std::string& str, const char* pattern, const std::string& with )
+{
+  for ( auto at = str.find( pattern ); at != std::string::npos; at = str.find( pattern, at + with.size() ) )
+    str.replace( at, 2, with );
+}
+
+static std::string ___tracy_capture_segment_path( const std::string& path, uint32_t segment )
+{
+  std::string result = path;
+  const std::string n = std::to_string( segment );
+  if ( result.find( "%n" ) != std::string::npos ) {
+    ___tracy_capture_replace( result, "%n", n );
+  }
+  else {
+    const auto slash = result.rfind( '/' );
+    const auto dot = result.rfind( '.' );
+    if ( dot != std::string::npos && ( slash == std::string::npos || dot > slash ) )
+      result.insert( dot, "." + n );
+    else
+      result += "." + n;
+  }
+  return result;
+}
+
+static void ___tracy_capture_write( const ___tracy_capture_segment& segment )
+{
+  const std::string partial = segment.path + ".part";
+  auto f = std::unique_ptr<tracy::FileWrite>( tracy::FileWrite::Open( partial.c_str(), tracy::FileCompression::Zstd, 3, 4 ) );
+  if ( !f ) {
+    fprintf( stderr, "tracy: could not open capture file '%s'\n", partial.c_str() );
+    return;
+  }
+
+  segment.worker->Write( *f, false );
+  f->Finish();
+  f.reset();
+
+  if ( rename( partial.c_str(), segment.path.c_str() ) != 0 )
+    fprintf( stderr, "tracy: could not rename capture file '%s' to '%s'\n", partial.c_str(), segment.path.c_str() );
+}
+
+static void ___tracy_capture_writer()
+{
+  ___tracy_interpose_suppress_thread();
+
+  std::unique_lock<std::mutex> lock( ___tracy_capture_mutex );
+  for ( ;; ) {
+    ___tracy_capture_cv.wait( lock, [] { return ___tracy_capture_writing || ___tracy_capture_done; } );
+    if ( !___tracy_capture_writing )
+      return;
+
+    // Keep the slot occupied until the segment has been written, so that the
+    // capture thread waits rather than holding a third segment in memory.
+    auto segment = ___tracy_capture_writing;
+    lock.unlock();
+    ___tracy_capture_write( *segment );
+    delete segment->worker;
+    delete segment;
+    lock.lock();
+
+    ___tracy_capture_writing = nullptr;
+    ___tracy_capture_writing_bytes.store( 0, std::memory_order_relaxed );
+    ___tracy_capture_cv.notify_all();
+  }
+}
+
+static void ___tracy_capture_hand_over( ___tracy_capture_segment* segment )
+{
+  std::unique_lock<std::mutex> lock( ___tracy_capture_mutex );
+  ___tracy_capture_cv.wait( lock, [] { return !___tracy_capture_writing; } );
+  ___tracy_capture_writing = segment;
+  ___tracy_capture_writing_bytes.store( segment->bytes, std::memory_order_relaxed );
+  ___tracy_capture_cv.notify_all();
+}
+
+// Wait for the client to accept the connection. Returns false if the capture
+// should stop, either because the profiler is shutting down or the client can
+// not be reached.
+static bool ___tracy_capture_connect( tracy::Worker& worker, uint16_t port )
+{
+  using namespace std::chrono;
+
+  while ( !worker.HasData() ) {
+    const auto status = worker.GetHandshakeStatus();
+    if ( status == tracy::HandshakeProtocolMismatch || status == tracy::HandshakeNotAvailable || status == tracy::HandshakeDropped ) {
+      fprintf( stderr, "tracy: offline capture could not connect to the client on port %u\n", port );
+      return false;
+    }
+    if ( ___tracy_capture_shutdown.load( std::memory_order_acquire ) )
+      return false;
+    std::this_thread::sleep_for( milliseconds( 10 ) );
+  }
+
+  if ( worker.GetPid() != (uint64_t)getpid() ) {
+    fprintf( stderr, "tracy: offline capture connected to another process on port %u; capture disabled\n", port );
+    worker.Disconnect();
+    while ( worker.IsConnected() )
+      std::this_thread::sleep_for( milliseconds( 10 ) );
+    return false;
+  }
+
+  return true;
+}
+
+static void ___tracy_capture_main( ___tracy_capture_config config )
+{
+  using namespace std::chrono;
+
+  // On Linux this is inherited by the threads the Worker creates; on macOS they
+  // are picked up by the thread introspection hook.
+  ___tracy_interpose_suppress_thread();
+
+  std::thread writer( ___tracy_capture_writer );
+
+  for ( uint32_t n = 0;; n++ ) {
+    auto worker = new tracy::Worker( "127.0.0.1", config.port, -1 );
+    if ( !___tracy_capture_connect( *worker, config.port ) ) {
+      delete worker;
+      break;
+    }
+
+    // Capture until the segment is full, or the client disconnects because
+    // the profiler is shutting down.
+    const auto start = steady_clock::now();
+    bool rotating = false;
+    int64_t bytes = 0;
+    while ( worker->IsConnected() ) {
+      std::this_thread::sleep_for( milliseconds( 100 ) );
+
+      bytes = tracy::memUsage.load( std::memory_order_relaxed ) - ___tracy_capture_writing_bytes.load( std::memory_order_relaxed );
+      const bool full = bytes >= config.rotate_bytes;
+      const bool expired = config.rotate_seconds > 0 && steady_clock::now() - start >= seconds( config.rotate_seconds );
+      if ( !rotating && ( full || expired ) ) {
+        worker->Disconnect();
+        rotating = true;
+      }
+    }
+
+    ___tracy_capture_hand_over( new ___tracy_capture_segment { worker, ___tracy_capture_segment_path( config.path, n ), bytes } );
+  }
+
+  {
+    std::lock_guard<std::mutex> lock( ___tracy_capture_mutex );
+    ___tracy_capture_done = true;
+    ___tracy_capture_cv.notify_all();
+  }
+  writer.join();
+}
+
+// Called from ___tracy_auto_process_init before the profiler is started, as it
+// determines how the client listens for connections. The capture thread itself
+// is not started until ___tracy_capture_start, below.
+extern "C" void ___tracy_init_offline_capture()
+{
+  const char* path = getenv( "SWIFT_TRACY_CAPTURE_FILE" );
+  if ( !path || !*path )
+    return;
+
+  int64_t rotate_mb = 1024;
+  int64_t rotate_seconds = 0;
+  if ( !___tracy_capture_parse( "SWIFT_TRACY_CAPTURE_ROTATE_MB", &rotate_mb ) || !___tracy_capture_parse( "SWIFT_TRACY_CAPTURE_ROTATE_SECONDS", &rotate_seconds ) )
+    return;
+  if ( rotate_mb == 0 ) {
+    fprintf( stderr, "tracy: SWIFT_TRACY_CAPTURE_ROTATE_MB must be positive; offline capture disabled\n" );
+    return;
+  }
+
+  uint16_t port = 0;
+  if ( const char* user_port = getenv( "TRACY_PORT" ) ) {
+    port = (uint16_t)atoi( user_port );
+  }
+  else {
+    port = ___tracy_capture_reserve_port();
+    if ( port == 0 ) {
+      fprintf( stderr, "tracy: offline capture could not reserve a port; capture disabled\n" );
+      return;
+    }
+    setenv( "TRACY_PORT", std::to_string( port ).c_str(), 1 );
+    ___tracy_capture_set_port = true;
+  }
+
+  auto config = new ___tracy_capture_config;
+  config->path = path;
+  ___tracy_capture_replace( config->path, "%p", std::to_string( getpid() ) );
+  config->port = port;
+  config->rotate_bytes = rotate_mb * 1024 * 1024;
+  config->rotate_seconds = rotate_seconds;
+
+  ___tracy_capture_pending = config;
+}
+
+// Called once the profiler has been started, and has therefore read the port
+// it listens on, so that child processes do not inherit it.
+extern "C" void ___tracy_restore_offline_capture_env()
+{
+  if ( ___tracy_capture_set_port ) {
+    unsetenv( "TRACY_PORT" );
+    ___tracy_capture_set_port = false;
+  }
+}
+
+// Must be called after the profiler has been shut down: the client waits for
+// the connected server to collect all outstanding data before it exits, so the
+// final segment is complete by the time the capture thread sees it disconnect.
+extern "C" void ___tracy_free_offline_capture()
+{
+  if ( ___tracy_capture_thread ) {
+    ___tracy_capture_shutdown.store( true, std::memory_order_release );
+    ___tracy_capture_thread->join();
+    delete ___tracy_capture_thread;
+    ___tracy_capture_thread = nullptr;
+  }
+
+  delete ___tracy_capture_pending;
+  ___tracy_capture_pending = nullptr;
+}
+
+// Start the capture thread once static initialisation of this translation
+// unit, and therefore of the server sources included above, is complete.
+// Events are only collected once the capture has connected to the client.
+struct ___tracy_capture_start_t {
+  ___tracy_capture_start_t() {
+    if ( ___tracy_capture_pending )
+      ___tracy_capture_thread = new std::thread( ___tracy_capture_main, *___tracy_capture_pending );
+  }
+};
+static ___tracy_capture_start_t ___tracy_capture_start;
+
+#endif
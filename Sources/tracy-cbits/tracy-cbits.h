@@ -60,6 +60,9 @@ TRACY_API TracyCZoneCtx ___tracy_emit_zone_begin_callstack( const struct ___trac
 TRACY_API TracyCZoneCtx ___tracy_emit_zone_begin_alloc( uint64_t srcloc, int active );
 TRACY_API TracyCZoneCtx ___tracy_emit_zone_begin_alloc_callstack( uint64_t srcloc, int depth, int active );
 TRACY_API void ___tracy_emit_zone_end( TracyCZoneCtx ctx );
+TRACY_API TracyCZoneCtx ___tracy_emit_zone_begin_active( const struct ___tracy_source_location_data* srcloc );
+TRACY_API TracyCZoneCtx ___tracy_emit_zone_begin_callstack_active( const struct ___tracy_source_location_data* srcloc, int depth );
+TRACY_API void ___tracy_emit_zone_end_active( TracyCZoneCtx ctx );
 TRACY_API void ___tracy_emit_zone_text( TracyCZoneCtx ctx, const char* txt, size_t size );
 TRACY_API void ___tracy_emit_zone_name( TracyCZoneCtx ctx, const char* txt, size_t size );
 TRACY_API void ___tracy_emit_zone_color( TracyCZoneCtx ctx, uint32_t color );
@@ -85,8 +88,20 @@ TRACY_API void ___tracy_emit_frame_mark_end( const char* name );
 
 TRACY_API void ___tracy_emit_message_appinfo( const char* txt, size_t size );
 
+TRACY_API void ___tracy_emit_plot( const char* name, double val );
+TRACY_API void ___tracy_emit_plot_float( const char* name, float val );
+TRACY_API void ___tracy_emit_plot_int( const char* name, int64_t val );
+
 TRACY_API int32_t ___tracy_connected(void);
 
+// Swift Concurrency instrumentation (tracy-concurrency.c)
+int32_t ___tracy_swift_concurrency_install(void);
+uint32_t ___tracy_swift_job_id(const void* job);
+void ___tracy_swift_mark_task_created(void);
+int32_t ___tracy_swift_take_task_created(void);
+void ___tracy_swift_mark_task_completed(void);
+int32_t ___tracy_swift_take_task_completed(void);
+
 #ifdef TRACY_MANUAL_LIFETIME
 TRACY_API void ___tracy_startup_profiler(void);
 TRACY_API void ___tracy_shutdown_profiler(void);
@@ -19,3 +19,71 @@
 // only ever a single instance of the client collecting instrumentation data.
 
 #include "tracy/public/TracyClient.cpp"
+
+// Specialised zone entry points, used by the #Zone macro when the zone is
+// known to be active at compile time, and by Zone.end() once it has checked
+// that the zone is active. These write directly to Tracy's queue, in the same
+// way as ___tracy_emit_zone_begin and ___tracy_emit_zone_end in
+// TracyProfiler.cpp, but without the checks on 'active'. Keep them in sync with
+// those functions when updating Tracy.
+
+#ifdef TRACY_ENABLE
+extern "C" {
+
+TRACY_API TracyCZoneCtx ___tracy_emit_zone_begin_active( const struct ___tracy_source_location_data* srcloc )
+{
+  ___tracy_c_zone_context ctx;
+#ifdef TRACY_ON_DEMAND
+  // Zones are only recorded while a server is connected
+  ctx.active = tracy::GetProfiler().IsConnected();
+  if( !ctx.active ) return ctx;
+#else
+  ctx.active = 1;
+#endif
+  const auto id = tracy::GetProfiler().GetNextZoneId();
+  ctx.id = id;
+
+#ifndef TRACY_NO_VERIFY
+  {
+    TracyQueuePrepareC( tracy::QueueType::ZoneValidation );
+    tracy::MemWrite( &item->zoneValidation.id, id );
+    TracyQueueCommitC( zoneValidationThread );
+  }
+#endif
+  {
+    TracyQueuePrepareC( tracy::QueueType::ZoneBegin );
+    tracy::MemWrite( &item->zoneBegin.time, tracy::Profiler::GetTime() );
+    tracy::MemWrite( &item->zoneBegin.srcloc, (uint64_t)srcloc );
+    TracyQueueCommitC( zoneBeginThread );
+  }
+  return ctx;
+}
+
+// Collecting the callstack dominates the cost of these zones, so this simply
+// forwards to the generic implementation.
+TRACY_API TracyCZoneCtx ___tracy_emit_zone_begin_callstack_active( const struct ___tracy_source_location_data* srcloc, int depth )
+{
+  return ___tracy_emit_zone_begin_callstack( srcloc, depth, 1 );
+}
+
+// The caller must have already checked that the zone is active
+TRACY_API void ___tracy_emit_zone_end_active( TracyCZoneCtx ctx )
+{
+#ifndef TRACY_NO_VERIFY
+  {
+    TracyQueuePrepareC( tracy::QueueType::ZoneValidation );
+    tracy::MemWrite( &item->zoneValidation.id, ctx.id );
+    TracyQueueCommitC( zoneValidationThread );
+  }
+#else
+  (void)ctx;
+#endif
+  {
+    TracyQueuePrepareC( tracy::QueueType::ZoneEnd );
+    tracy::MemWrite( &item->zoneEnd.time, tracy::Profiler::GetTime() );
+    TracyQueueCommitC( zoneEndThread );
+  }
+}
+
+}
+#endif
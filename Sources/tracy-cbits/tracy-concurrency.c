@@ -0,0 +1,319 @@
+// Copyright (c) 2026 The swift-tracy authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Swift Concurrency scheduling instrumentation.
+//
+// The Swift concurrency runtime exports a set of hook variables which, when
+// set, are called instead of the default implementation of the corresponding
+// executor operation (see swift/Runtime/ConcurrencyHooks.def). Each hook
+// receives the original implementation as its last argument, which it must
+// call to actually perform the operation.
+//
+// We use the enqueue hooks to observe every task which becomes runnable on the
+// global concurrent executor, is scheduled to run after a delay or deadline
+// (e.g. Task.sleep), or is sent to the main executor. Since these are called on
+// every enqueue, each is reported as a single point in a plot whose value is
+// the task ID, rather than formatting a message.
+//
+// The runtime does not provide a hook for when a job starts running. Instead,
+// the global enqueue hook performs the enqueue itself: it sends the job to the
+// same dispatch queue the runtime would have used, but via a trampoline which
+// records the time the job spent waiting in the queue and runs it inside a
+// zone whose value is the task ID. This gives the queueing delay and the run
+// slices of every task on the default executor. The runtime does not tell us
+// whether a slice ended because the task suspended or completed, nor whether a
+// job is a newly created task; see TracingTaskExecutor in the Swift module for
+// that. If another global enqueue hook was already installed, for example a
+// custom global executor, we only plot the enqueue and leave the job to it.
+//
+// The hooks, as well as the runtime and dispatch functions used by the
+// trampoline, are resolved dynamically, so that we do not need to link against
+// the concurrency runtime, and are only installed on request.
+
+#ifdef TRACY_ENABLE
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // required for RTLD_DEFAULT
+#endif
+
+// See the note in tracy-interpose-linux.c regarding why we don't include our
+// own header here.
+
+/* #include "tracy-cbits.h" */
+
+#include "tracy/public/tracy/TracyC.h"
+
+#include <dlfcn.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#if defined(__clang__)
+#define SWIFT_CC __attribute__((swiftcall))
+#else
+#define SWIFT_CC
+#endif
+
+// The header common to all jobs scheduled by the Swift concurrency runtime
+// (swift/ABI/Task.h). For tasks, the ID is the task's ID.
+struct ___tracy_swift_job
+{
+  void* metadata;
+  uintptr_t refcounts;
+  void* scheduler_private[2];
+  uint32_t flags;
+  uint32_t id;
+};
+
+#define TRACY_SWIFT_JOB_KIND(flags)      ((flags) & 0xff)
+#define TRACY_SWIFT_JOB_KIND_TASK        0
+#define TRACY_SWIFT_JOB_PRIORITY(flags)  (((flags) >> 8) & 0xff)
+
+typedef struct ___tracy_swift_job Job;
+
+typedef SWIFT_CC void (*enqueue_global_original)(Job* job);
+typedef SWIFT_CC void (*enqueue_global_hook)(Job* job, enqueue_global_original original);
+
+typedef SWIFT_CC void (*enqueue_delay_original)(unsigned long long delay, Job* job);
+typedef SWIFT_CC void (*enqueue_delay_hook)(unsigned long long delay, Job* job, enqueue_delay_original original);
+
+typedef SWIFT_CC void (*enqueue_deadline_original)(long long sec, long long nsec, long long tsec, long long tnsec, int clock, Job* job);
+typedef SWIFT_CC void (*enqueue_deadline_hook)(long long sec, long long nsec, long long tsec, long long tnsec, int clock, Job* job, enqueue_deadline_original original);
+
+typedef SWIFT_CC void (*enqueue_main_original)(Job* job);
+typedef SWIFT_CC void (*enqueue_main_hook)(Job* job, enqueue_main_original original);
+
+// swift/ABI/Executor.h; the generic executor is the null reference
+typedef struct
+{
+  const void* identity;
+  uintptr_t implementation;
+} SerialExecutorRef;
+
+typedef SWIFT_CC void (*swift_job_run_fn)(Job* job, SerialExecutorRef executor);
+typedef void* (*dispatch_get_global_queue_fn)(intptr_t identifier, uintptr_t flags);
+typedef void (*dispatch_async_f_fn)(void* queue, void* context, void (*work)(void* context));
+
+// Selects the width-limited queues which the concurrency runtime uses on
+// Darwin (DISPATCH_QUEUE_COOPERATIVE). Elsewhere, and on systems which do not
+// support it, the runtime uses the regular global queues.
+#define TRACY_DISPATCH_QUEUE_COOPERATIVE 0x4
+
+static swift_job_run_fn ___tracy_swift_job_run;
+static dispatch_get_global_queue_fn ___tracy_dispatch_get_global_queue;
+static dispatch_async_f_fn ___tracy_dispatch_async_f;
+
+// Any hooks which were already installed when we installed ours, which we
+// chain to instead of the original implementation.
+static enqueue_global_hook ___tracy_prev_enqueue_global;
+static enqueue_delay_hook ___tracy_prev_enqueue_delay;
+static enqueue_deadline_hook ___tracy_prev_enqueue_deadline;
+static enqueue_main_hook ___tracy_prev_enqueue_main;
+
+static inline void ___tracy_swift_job_plot(const Job* job, const char* plot)
+{
+  if (TracyCIsStarted && TRACY_SWIFT_JOB_KIND(job->flags) == TRACY_SWIFT_JOB_KIND_TASK) {
+    ___tracy_emit_plot_int(plot, job->id);
+  }
+}
+
+static inline uint64_t ___tracy_swift_now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000 + (uint64_t) ts.tv_nsec;
+}
+
+// The queue the runtime would send a job of the given priority to. The job
+// priorities are the same values as the dispatch QoS classes, with zero
+// (unspecified) selecting the default queue.
+static void* ___tracy_swift_global_queue(uint32_t priority)
+{
+  void* queue = NULL;
+#if defined(__APPLE__)
+  queue = ___tracy_dispatch_get_global_queue(priority, TRACY_DISPATCH_QUEUE_COOPERATIVE);
+#endif
+  if (queue == NULL)
+    queue = ___tracy_dispatch_get_global_queue(priority, 0);
+  return queue;
+}
+
+static const struct ___tracy_source_location_data ___tracy_swift_job_srcloc = {
+  "task", "swift_job_run", __FILE__, __LINE__, 0x8899aa
+};
+
+// Runs a task which was enqueued on the global executor by our hook. The
+// executor owns the job's scheduler-private fields while the job is queued,
+// which is where the hook left the time it was enqueued.
+static void ___tracy_swift_run_job(void* context)
+{
+  Job* job = (Job*) context;
+
+  if (!TracyCIsStarted) {
+    ___tracy_swift_job_run(job, (SerialExecutorRef){ NULL, 0 });
+    return;
+  }
+
+  // The job may be destroyed when it returns, so read its ID first
+  const uint32_t id = job->id;
+  const uint64_t enqueued = (uint64_t)(uintptr_t) job->scheduler_private[0];
+  ___tracy_emit_plot_int("task queue delay (ns)", (int64_t)(___tracy_swift_now() - enqueued));
+
+  TracyCZoneCtx ctx = ___tracy_emit_zone_begin(&___tracy_swift_job_srcloc, 1);
+  ___tracy_emit_zone_value(ctx, id);
+  ___tracy_swift_job_run(job, (SerialExecutorRef){ NULL, 0 });
+  ___tracy_emit_zone_end(ctx);
+}
+
+static SWIFT_CC void ___tracy_enqueue_global(Job* job, enqueue_global_original original)
+{
+  if (TracyCIsStarted && TRACY_SWIFT_JOB_KIND(job->flags) == TRACY_SWIFT_JOB_KIND_TASK) {
+    ___tracy_emit_plot_int("task enqueued", job->id);
+
+    if (___tracy_prev_enqueue_global == NULL && ___tracy_swift_job_run != NULL) {
+      void* queue = ___tracy_swift_global_queue(TRACY_SWIFT_JOB_PRIORITY(job->flags));
+      if (queue != NULL) {
+        job->scheduler_private[0] = (void*)(uintptr_t) ___tracy_swift_now();
+        ___tracy_dispatch_async_f(queue, job, ___tracy_swift_run_job);
+        return;
+      }
+    }
+  }
+
+  if (___tracy_prev_enqueue_global)
+    ___tracy_prev_enqueue_global(job, original);
+  else
+    original(job);
+}
+
+static SWIFT_CC void ___tracy_enqueue_delay(unsigned long long delay, Job* job, enqueue_delay_original original)
+{
+  ___tracy_swift_job_plot(job, "task delayed");
+
+  if (___tracy_prev_enqueue_delay)
+    ___tracy_prev_enqueue_delay(delay, job, original);
+  else
+    original(delay, job);
+}
+
+// Used by Task.sleep(until:) and Task.sleep(for:), which take a clock.
+static SWIFT_CC void ___tracy_enqueue_deadline(long long sec, long long nsec, long long tsec, long long tnsec, int clock, Job* job, enqueue_deadline_original original)
+{
+  ___tracy_swift_job_plot(job, "task delayed");
+
+  if (___tracy_prev_enqueue_deadline)
+    ___tracy_prev_enqueue_deadline(sec, nsec, tsec, tnsec, clock, job, original);
+  else
+    original(sec, nsec, tsec, tnsec, clock, job);
+}
+
+static SWIFT_CC void ___tracy_enqueue_main(Job* job, enqueue_main_original original)
+{
+  ___tracy_swift_job_plot(job, "task enqueued on main");
+
+  if (___tracy_prev_enqueue_main)
+    ___tracy_prev_enqueue_main(job, original);
+  else
+    original(job);
+}
+
+// Not thread safe; this is expected to be called once, early during startup.
+int32_t ___tracy_swift_concurrency_install(void)
+{
+  static int32_t installed = 0;
+  if (installed)
+    return 1;
+
+  enqueue_global_hook* global_hook = (enqueue_global_hook*) dlsym(RTLD_DEFAULT, "swift_task_enqueueGlobal_hook");
+  enqueue_delay_hook* delay_hook = (enqueue_delay_hook*) dlsym(RTLD_DEFAULT, "swift_task_enqueueGlobalWithDelay_hook");
+  enqueue_deadline_hook* deadline_hook = (enqueue_deadline_hook*) dlsym(RTLD_DEFAULT, "swift_task_enqueueGlobalWithDeadline_hook");
+  enqueue_main_hook* main_hook = (enqueue_main_hook*) dlsym(RTLD_DEFAULT, "swift_task_enqueueMainExecutor_hook");
+
+  // The concurrency runtime is not loaded (or was linked statically without
+  // exporting its symbols), so there is nothing to instrument.
+  if (global_hook == NULL)
+    return 0;
+
+  // Only used to run jobs on the global executor ourselves; without them we
+  // still plot each enqueue, but leave running the job to the runtime.
+  swift_job_run_fn job_run = (swift_job_run_fn) dlsym(RTLD_DEFAULT, "swift_job_run");
+  dispatch_get_global_queue_fn get_global_queue = (dispatch_get_global_queue_fn) dlsym(RTLD_DEFAULT, "dispatch_get_global_queue");
+  dispatch_async_f_fn async_f = (dispatch_async_f_fn) dlsym(RTLD_DEFAULT, "dispatch_async_f");
+
+  if (job_run != NULL && get_global_queue != NULL && async_f != NULL) {
+    ___tracy_dispatch_get_global_queue = get_global_queue;
+    ___tracy_dispatch_async_f = async_f;
+    ___tracy_swift_job_run = job_run;
+  }
+
+  ___tracy_prev_enqueue_global = *global_hook;
+  *global_hook = ___tracy_enqueue_global;
+
+  if (delay_hook != NULL) {
+    ___tracy_prev_enqueue_delay = *delay_hook;
+    *delay_hook = ___tracy_enqueue_delay;
+  }
+
+  if (deadline_hook != NULL) {
+    ___tracy_prev_enqueue_deadline = *deadline_hook;
+    *deadline_hook = ___tracy_enqueue_deadline;
+  }
+
+  if (main_hook != NULL) {
+    ___tracy_prev_enqueue_main = *main_hook;
+    *main_hook = ___tracy_enqueue_main;
+  }
+
+  installed = 1;
+  return 1;
+}
+
+uint32_t ___tracy_swift_job_id(const void* job)
+{
+  return ((const Job*) job)->id;
+}
+
+// Used by TracingTaskExecutor to learn that the job it is about to be given was
+// just created, or that the job it is currently running has just completed.
+// Both are only ever set and consumed on the same thread, as the runtime
+// enqueues a new task synchronously from Task.init, and a task completes within
+// the job that returns from its body.
+static __thread int32_t ___tracy_swift_task_created;
+static __thread int32_t ___tracy_swift_task_completed;
+
+void ___tracy_swift_mark_task_created(void)
+{
+  ___tracy_swift_task_created = 1;
+}
+
+int32_t ___tracy_swift_take_task_created(void)
+{
+  int32_t created = ___tracy_swift_task_created;
+  ___tracy_swift_task_created = 0;
+  return created;
+}
+
+void ___tracy_swift_mark_task_completed(void)
+{
+  ___tracy_swift_task_completed = 1;
+}
+
+int32_t ___tracy_swift_take_task_completed(void)
+{
+  int32_t completed = ___tracy_swift_task_completed;
+  ___tracy_swift_task_completed = 0;
+  return completed;
+}
+
+#endif  // TRACY_ENABLE
@@ -33,6 +33,12 @@ extern void ___tracy_init_demangle_buffer();
 extern void ___tracy_free_demangle_buffer();
 #endif
 
+#ifdef TRACY_OFFLINE_CAPTURE
+extern "C" void ___tracy_init_offline_capture();
+extern "C" void ___tracy_restore_offline_capture_env();
+extern "C" void ___tracy_free_offline_capture();
+#endif
+
 #if defined(__APPLE__)
 extern "C" void ___tracy_init_malloc_logger();
 extern "C" void ___tracy_deinit_malloc_logger();
@@ -80,10 +86,20 @@ static tracy::CUDACtx* ___tracy_cuda_context = nullptr;
 
 static void ___tracy_auto_process_init(void)
 {
+  // Must come first, as it configures how the profiler listens for connections
+#if defined(TRACY_OFFLINE_CAPTURE)
+  ___tracy_init_offline_capture();
+#endif
+
 #if defined(TRACY_MANUAL_LIFETIME) && defined(TRACY_DELAYED_INIT)
   tracy::StartupProfiler();
 #endif
 
+  // The profiler has read its configuration from the environment by now
+#if defined(TRACY_OFFLINE_CAPTURE)
+  ___tracy_restore_offline_capture_env();
+#endif
+
 #if defined(TRACY_DEMANGLE)
   ___tracy_init_demangle_buffer();
 #endif
@@ -116,6 +132,10 @@ static void ___tracy_auto_process_done(void)
 #if defined(TRACY_MANUAL_LIFETIME) && defined(TRACY_DELAYED_INIT)
   tracy::ShutdownProfiler();
 #endif
+
+#if defined(TRACY_OFFLINE_CAPTURE)
+  ___tracy_free_offline_capture();
+#endif
 }
 
 #endif
@@ -43,11 +43,13 @@
 #include "tracy/public/tracy/TracyC.h"
 
 #include <assert.h>
+#include <errno.h>
 #include <dlfcn.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <malloc.h>
+#include <pthread.h>
 
 #if defined(__GNUC__) || defined(__clang__)
 #define TRACY_UNLIKELY(x)     (__builtin_expect(!!(x),false))
@@ -57,6 +59,17 @@
 #define TRACY_LIKELY(x)       (x)
 #endif
 
+// Threads belonging to the offline capture (tracy-capture.cpp) are excluded
+// from tracking, otherwise the capture's own allocations would be recorded in
+// the trace it is writing. The flag is inherited by any threads they create, so
+// that it also covers the threads spawned internally by the Tracy server.
+#ifdef TRACY_OFFLINE_CAPTURE
+static __thread int ___tracy_interpose_suppressed __attribute__((tls_model("initial-exec")));
+#define TRACY_INTERPOSE_ACTIVE  (TracyCIsStarted && !___tracy_interpose_suppressed)
+#else
+#define TRACY_INTERPOSE_ACTIVE  TracyCIsStarted
+#endif
+
 #define DLSYM_REAL(NAME) \
   static __typeof__(NAME)* real_##NAME = NULL; \
   if TRACY_UNLIKELY(!real_##NAME) { \
@@ -73,7 +86,7 @@ static void* tracy_malloc(size_t size)
   if (ptr == NULL)
     return NULL;
 
-  if TRACY_LIKELY(TracyCIsStarted) {
+  if TRACY_LIKELY(TRACY_INTERPOSE_ACTIVE) {
     TracyCAlloc(ptr, size);
   }
 
@@ -88,7 +101,7 @@ static void* tracy_calloc(size_t count, size_t size)
   if (ptr == NULL)
     return NULL;
 
-  if TRACY_LIKELY(TracyCIsStarted) {
+  if TRACY_LIKELY(TRACY_INTERPOSE_ACTIVE) {
     TracyCAlloc(ptr, count * size);
   }
 
@@ -100,7 +113,7 @@ static void tracy_free(void *ptr)
   DLSYM_REAL(free);
 
   // free(NULL) is a no-op; don't emit a spurious TracyCFree at address 0.
-  if (ptr != NULL && TracyCIsStarted) {
+  if (ptr != NULL && TRACY_INTERPOSE_ACTIVE) {
     TracyCFree(ptr);
   }
 
@@ -122,7 +135,7 @@ static void* tracy_realloc(void* ptr, size_t new_size)
   if (new_ptr == NULL)
     return NULL;  // OOM — ptr is still valid and still tracked
 
-  if TRACY_LIKELY(TracyCIsStarted) {
+  if TRACY_LIKELY(TRACY_INTERPOSE_ACTIVE) {
     TracyCFree(ptr);
     TracyCAlloc(new_ptr, new_size);
   }
@@ -138,7 +151,7 @@ static void* tracy_memalign(size_t alignment, size_t size)
   if (ptr == NULL)
     return NULL;
 
-  if TRACY_LIKELY(TracyCIsStarted) {
+  if TRACY_LIKELY(TRACY_INTERPOSE_ACTIVE) {
     TracyCAlloc(ptr, size);
   }
 
@@ -153,7 +166,7 @@ static int tracy_posix_memalign(void** ptr, size_t alignment, size_t size)
   if (result != 0)
     return result;
 
-  if TRACY_LIKELY(TracyCIsStarted) {
+  if TRACY_LIKELY(TRACY_INTERPOSE_ACTIVE) {
     TracyCAlloc(*ptr, size);
   }
 
@@ -169,7 +182,7 @@ static void* tracy_aligned_alloc(size_t alignment, size_t size)
   if (ptr == NULL)
     return NULL;
 
-  if TRACY_LIKELY(TracyCIsStarted) {
+  if TRACY_LIKELY(TRACY_INTERPOSE_ACTIVE) {
     TracyCAlloc(ptr, size);
   }
 
@@ -177,6 +190,52 @@ static void* tracy_aligned_alloc(size_t alignment, size_t size)
 }
 #endif
 
+#ifdef TRACY_OFFLINE_CAPTURE
+struct ___tracy_thread_start
+{
+  void* (*start_routine)(void*);
+  void* arg;
+};
+
+static void* ___tracy_suppressed_thread_start(void* data)
+{
+  ___tracy_interpose_suppressed = 1;
+
+  struct ___tracy_thread_start start = *(struct ___tracy_thread_start*) data;
+  free(data);
+
+  return start.start_routine(start.arg);
+}
+
+static int tracy_pthread_create(pthread_t* thread, const pthread_attr_t* attr, void* (*start_routine)(void*), void* arg)
+{
+  DLSYM_REAL(pthread_create);
+
+  if TRACY_LIKELY(!___tracy_interpose_suppressed)
+    return real_pthread_create(thread, attr, start_routine, arg);
+
+  // Allocated (untracked) by this thread and freed by the new thread once
+  // it has marked itself as suppressed.
+  struct ___tracy_thread_start* start = malloc(sizeof(*start));
+  if (start == NULL)
+    return EAGAIN;
+
+  start->start_routine = start_routine;
+  start->arg = arg;
+
+  int result = real_pthread_create(thread, attr, ___tracy_suppressed_thread_start, start);
+  if (result != 0)
+    free(start);
+
+  return result;
+}
+
+void ___tracy_interpose_suppress_thread(void)
+{
+  ___tracy_interpose_suppressed = 1;
+}
+#endif
+
 // On Linux/ELF, use GCC/Clang alias attributes to export our wrappers under
 // the standard allocator names, or fall back to direct symbol definitions.
 #if (defined(__GNUC__) || defined(__clang__))
@@ -189,11 +248,13 @@ static void* tracy_aligned_alloc(size_t alignment, size_t size)
   #define TRACY_FORWARD1(fun,x)      TRACY_FORWARD(fun)
   #define TRACY_FORWARD2(fun,x,y)    TRACY_FORWARD(fun)
   #define TRACY_FORWARD3(fun,x,y,z)  TRACY_FORWARD(fun)
+  #define TRACY_FORWARD4(fun,x,y,z,w) TRACY_FORWARD(fun)
   #define TRACY_FORWARD0(fun,x)      TRACY_FORWARD(fun)
 #else
   #define TRACY_FORWARD1(fun,x)      { return fun(x); }
   #define TRACY_FORWARD2(fun,x,y)    { return fun(x,y); }
   #define TRACY_FORWARD3(fun,x,y,z)  { return fun(x,y,z); }
+  #define TRACY_FORWARD4(fun,x,y,z,w) { return fun(x,y,z,w); }
   #define TRACY_FORWARD0(fun,x)      { fun(x); }
 #endif
 
@@ -206,5 +267,9 @@ void* memalign(size_t alignment, size_t size)                   TRACY_FORWARD2(t
 #if !defined(__GLIBC__) || __USE_ISOC11
 void* aligned_alloc(size_t alignment, size_t size)              TRACY_FORWARD2(tracy_aligned_alloc, alignment, size)
 #endif
+#ifdef TRACY_OFFLINE_CAPTURE
+int   pthread_create(pthread_t* thread, const pthread_attr_t* attr, void* (*start_routine)(void*), void* arg)
+                                                                TRACY_FORWARD4(tracy_pthread_create, thread, attr, start_routine, arg)
+#endif
 
 #endif  // TRACY_ENABLE
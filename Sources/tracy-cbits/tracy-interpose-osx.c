@@ -44,6 +44,11 @@
 #include <pthread.h>
 #include <stdint.h>
 
+#ifdef TRACY_OFFLINE_CAPTURE
+#include <pthread/introspection.h>
+#include <stdatomic.h>
+#endif
+
 // malloc_logger is a libmalloc private API used by Instruments for memory
 // profiling. It is not declared in the public SDK headers but has been stable
 // since macOS 10.6. Declaring it here avoids a dependency on private headers.
@@ -99,15 +104,67 @@ static void ___tracy_malloc_logger(
     pthread_setspecific(___tracy_busy_key, (void*)0);
 }
 
+#ifdef TRACY_OFFLINE_CAPTURE
+// Threads belonging to the offline capture (tracy-capture.cpp) are excluded
+// from tracking, otherwise the capture's own allocations would be recorded in
+// the trace it is writing. Setting the reentrancy guard permanently means the
+// logger returns immediately for that thread.
+//
+// The Tracy server does most of its work on threads it creates internally, so
+// the exclusion must be inherited by any thread an excluded thread creates. We
+// use the thread introspection hook for that: it is told about a new thread on
+// the thread which creates it, but the new thread can only mark itself once it
+// starts running, so threads in between are remembered here. The capture only
+// creates a handful of threads at a time.
+#define TRACY_PENDING_THREADS 64
+
+static _Atomic(pthread_t) ___tracy_pending_threads[TRACY_PENDING_THREADS];
+static pthread_introspection_hook_t ___tracy_prev_introspection_hook;
+
+static void ___tracy_introspection_hook(unsigned int event, pthread_t thread, void* addr, size_t size)
+{
+    if (event == PTHREAD_INTROSPECTION_THREAD_CREATE && pthread_getspecific(___tracy_busy_key)) {
+        for (int i = 0; i < TRACY_PENDING_THREADS; ++i) {
+            pthread_t expected = (pthread_t)0;
+            if (atomic_compare_exchange_strong(&___tracy_pending_threads[i], &expected, thread))
+                break;
+        }
+    }
+    else if (event == PTHREAD_INTROSPECTION_THREAD_START) {
+        for (int i = 0; i < TRACY_PENDING_THREADS; ++i) {
+            pthread_t expected = thread;
+            if (atomic_compare_exchange_strong(&___tracy_pending_threads[i], &expected, (pthread_t)0)) {
+                pthread_setspecific(___tracy_busy_key, (void*)1);
+                break;
+            }
+        }
+    }
+
+    if (___tracy_prev_introspection_hook)
+        ___tracy_prev_introspection_hook(event, thread, addr, size);
+}
+
+void ___tracy_interpose_suppress_thread(void)
+{
+    pthread_setspecific(___tracy_busy_key, (void*)1);
+}
+#endif
+
 void ___tracy_init_malloc_logger(void)
 {
     pthread_key_create(&___tracy_busy_key, NULL);
     ___tracy_prev_malloc_logger = malloc_logger;
     malloc_logger = ___tracy_malloc_logger;
+#ifdef TRACY_OFFLINE_CAPTURE
+    ___tracy_prev_introspection_hook = pthread_introspection_hook_install(___tracy_introspection_hook);
+#endif
 }
 
 void ___tracy_deinit_malloc_logger(void)
 {
+#ifdef TRACY_OFFLINE_CAPTURE
+    pthread_introspection_hook_install(___tracy_prev_introspection_hook);
+#endif
     if (malloc_logger == ___tracy_malloc_logger)
         malloc_logger = ___tracy_prev_malloc_logger;
     pthread_key_delete(___tracy_busy_key);
@@ -19,8 +19,9 @@ import SwiftSyntaxMacros
 struct TracyMacros: CompilerPlugin {
     let providingMacros: [Macro.Type] = [
         // marking zones
-        // #ZoneScoped blocked on apple/swift#73707
         Zone.self,
         ZoneDisabled.self,
+        ZoneScoped.self,
+        ZoneScopedDisabled.self,
     ]
 }
@@ -20,105 +20,7 @@ public struct Zone: ExpressionMacro {
         of node: some FreestandingMacroExpansionSyntax,
         in context: some MacroExpansionContext
     ) throws -> ExprSyntax {
-        let loc = context.makeUniqueName("loc")
-        let ctx = context.makeUniqueName("ctx")
-
-        // fallback to #function, although this will just produce garbage
-        let function = context.lexicalContext.first?.functionName(in: context) ?? "#function"
-        var name: ExprSyntax = "nil"
-        var colour: ExprSyntax = "0"
-        var callstack: ExprSyntax? = nil
-        var active: ExprSyntax = "true"
-
-        for arg in node.arguments {
-            if let label = arg.label?.text {
-                switch label {
-                    case "name":
-                        name = "StaticString(stringLiteral: \(arg.expression)).utf8Start"
-
-                    case "colour":
-                        colour = arg.expression
-
-                    case "callstack":
-                        callstack = arg.expression
-
-                    case "active":
-                        active = arg.expression
-
-                    default:
-                        throw TracyMacroError.invalidArgument("\(label)")
-                }
-            }
-        }
-
-        /* Swift does not have local static variables, which are required by
-         * Tracy (otherwise you must use the _alloc functions have higher
-         * overhead since they need to copy a lot of data around). We can work
-         * around this by defining a local struct type with a static variable
-         * inside:
-         *
-         * > func foo() {
-         * >     struct A { static var bar = ... }
-         * >     ...
-         * > }
-         *
-         * One drawback of this trick is that we can no longer use the usual
-         * #function macro, since this will return the struct name ('A' in this
-         * case) not the name of the parent function ('foo') which is what we
-         * are actually interested in.
-         *
-         * Note that we need to be _very_ careful how this struct is
-         * initialised. Because Swift will not automatically cast pointer types
-         * between char* and uint8_t* for _struct_ initialisers (like it will
-         * for function calls) we need to wrangle the types ourselves. If we
-         * follow the usual options like 'withCString' or even
-         * UnsafeRawPointer(...).assumingMemoryBound(to:), we'll end up with a
-         * @swift_once() initialisation function in the generated code, which we
-         * don't want.
-         *
-         * In the end it was necessary to change the type of the source location
-         * struct in the C header to have a type that aligns with what Swift
-         * wants. Note that this relies on a further oddity of how Swift/C++
-         * interop works, in that the header file that the Swift interop layer
-         * gets its types and definitions from does _not_ have to be the same as
-         * what the C++ compiler uses.
-         */
-        if let depth = callstack {
-            return """
-            {
-                struct \(loc) {
-                    @exclusivity(unchecked)
-                    nonisolated(unsafe)
-                    static var data = ___tracy_source_location_data(
-                        name: \(name),
-                        function: StaticString(stringLiteral: \(literal: function)).utf8Start,
-                        file: StaticString(stringLiteral: #file).utf8Start,
-                        line: #line,
-                        color: \(colour))
-                    }
-                let \(ctx) = ___tracy_emit_zone_begin_callstack(&\(loc).data, \(depth), \(active) ? 1 : 0)
-                return Tracy.Zone.init(with: \(ctx))
-            }()
-            """
-        }
-        else {
-            return """
-            {
-                struct \(loc) {
-                    @exclusivity(unchecked)
-                    nonisolated(unsafe)
-                    static var data = ___tracy_source_location_data(
-                        name: \(name),
-                        function: StaticString(stringLiteral: \(literal: function)).utf8Start,
-                        file: StaticString(stringLiteral: #file).utf8Start,
-                        line: #line,
-                        color: \(colour))
-                    }
-                let \(ctx) = ___tracy_emit_zone_begin(&\(loc).data, \(active) ? 1 : 0)
-                return Tracy.Zone.init(with: \(ctx))
-            }()
-            """
-        }
+        try expandZone(of: node, in: context, as: "Tracy.Zone")
     }
 }
 
@@ -131,6 +33,131 @@ public struct ZoneDisabled: ExpressionMacro {
     }
 }
 
+public struct ZoneScoped: ExpressionMacro {
+    public static func expansion(
+        of node: some FreestandingMacroExpansionSyntax,
+        in context: some MacroExpansionContext
+    ) throws -> ExprSyntax {
+        try expandZone(of: node, in: context, as: "Tracy.ScopedZone")
+    }
+}
+
+public struct ZoneScopedDisabled: ExpressionMacro {
+    public static func expansion(
+        of _: some FreestandingMacroExpansionSyntax,
+        in _: some MacroExpansionContext
+    ) throws -> ExprSyntax {
+        "Tracy.ScopedZone.init(with: ___tracy_c_zone_context(id: 0, active: 0))"
+    }
+}
+
+private func expandZone(
+    of node: some FreestandingMacroExpansionSyntax,
+    in context: some MacroExpansionContext,
+    as type: TypeSyntax
+) throws -> ExprSyntax {
+    let loc = context.makeUniqueName("loc")
+    let ctx = context.makeUniqueName("ctx")
+
+    // fallback to #function, although this will just produce garbage
+    let function = context.lexicalContext.first?.functionName(in: context) ?? "#function"
+    var name: ExprSyntax = "nil"
+    var colour: ExprSyntax = "0"
+    var callstack: ExprSyntax? = nil
+    var active: ExprSyntax? = nil
+
+    for arg in node.arguments {
+        if let label = arg.label?.text {
+            switch label {
+                case "name":
+                    name = "StaticString(stringLiteral: \(arg.expression)).utf8Start"
+
+                case "colour":
+                    colour = arg.expression
+
+                case "callstack":
+                    callstack = arg.expression
+
+                case "active":
+                    active = arg.expression
+
+                default:
+                    throw TracyMacroError.invalidArgument("\(label)")
+            }
+        }
+    }
+
+    // A zone which is literally 'active: false' does not need to call into
+    // Tracy at all, and a literal callstack depth of zero is the same as not
+    // collecting the callstack.
+    if let literal = active?.as(BooleanLiteralExprSyntax.self) {
+        if literal.literal.tokenKind == .keyword(.false) {
+            return "\(type).init(with: ___tracy_c_zone_context(id: 0, active: 0))"
+        }
+        active = nil
+    }
+    if let literal = callstack?.as(IntegerLiteralExprSyntax.self), literal.representedLiteralValue == 0 {
+        callstack = nil
+    }
+
+    let begin: ExprSyntax =
+        switch (callstack, active) {
+            case (nil, nil): "___tracy_emit_zone_begin_active(&\(loc).data)"
+            case let (depth?, nil): "___tracy_emit_zone_begin_callstack_active(&\(loc).data, \(depth))"
+            case let (nil, active?): "___tracy_emit_zone_begin(&\(loc).data, \(active) ? 1 : 0)"
+            case let (depth?, active?): "___tracy_emit_zone_begin_callstack(&\(loc).data, \(depth), \(active) ? 1 : 0)"
+        }
+
+    /* Swift does not have local static variables, which are required by
+     * Tracy (otherwise you must use the _alloc functions have higher
+     * overhead since they need to copy a lot of data around). We can work
+     * around this by defining a local struct type with a static variable
+     * inside:
+     *
+     * > func foo() {
+     * >     struct A { static var bar = ... }
+     * >     ...
+     * > }
+     *
+     * One drawback of this trick is that we can no longer use the usual
+     * #function macro, since this will return the struct name ('A' in this
+     * case) not the name of the parent function ('foo') which is what we
+     * are actually interested in.
+     *
+     * Note that we need to be _very_ careful how this struct is
+     * initialised. Because Swift will not automatically cast pointer types
+     * between char* and uint8_t* for _struct_ initialisers (like it will
+     * for function calls) we need to wrangle the types ourselves. If we
+     * follow the usual options like 'withCString' or even
+     * UnsafeRawPointer(...).assumingMemoryBound(to:), we'll end up with a
+     * @swift_once() initialisation function in the generated code, which we
+     * don't want.
+     *
+     * In the end it was necessary to change the type of the source location
+     * struct in the C header to have a type that aligns with what Swift
+     * wants. Note that this relies on a further oddity of how Swift/C++
+     * interop works, in that the header file that the Swift interop layer
+     * gets its types and definitions from does _not_ have to be the same as
+     * what the C++ compiler uses.
+     */
+    return """
+    {
+        struct \(loc) {
+            @exclusivity(unchecked)
+            nonisolated(unsafe)
+            static var data = ___tracy_source_location_data(
+                name: \(name),
+                function: StaticString(stringLiteral: \(literal: function)).utf8Start,
+                file: StaticString(stringLiteral: #file).utf8Start,
+                line: #line,
+                color: \(colour))
+            }
+        let \(ctx) = \(begin)
+        return \(type).init(with: \(ctx))
+    }()
+    """
+}
+
 // Stolen from swift-syntax@600.0.0-prerelease-2024-05-14:Tests/SwiftSyntaxMacroExpansionTest/LexicalContextTests.swift
 
 private extension PatternBindingSyntax {
@@ -0,0 +1,149 @@
+// Copyright (c) 2026 The swift-tracy authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// A bump (arena) allocator which reports the memory it holds to a named
+// MemoryPool.
+//
+// The arena reserves memory in large chunks and hands out regions by bumping a
+// cursor through the current chunk. Individual regions are never freed;
+// instead the whole arena is rewound with reset(), which keeps the chunks
+// around so that they can be reused by the next round of allocations.
+//
+// Every region handed out is reported to the pool, and reset() reports them
+// all as freed, so the Memory panel shows each round of allocations and the
+// same addresses being reused by the next. The pointers are remembered in an
+// array which is retained across resets, so once it has grown to the number of
+// regions used per round this adds no malloc traffic of its own.
+//
+// An arena is not thread safe.
+public final class Arena {
+    struct Chunk {
+        let base: UnsafeMutableRawPointer
+        let size: Int
+    }
+
+    public let pool: MemoryPool
+    public let chunkSize: Int
+
+    @usableFromInline
+    let callstack: Int32
+    var chunks: [Chunk] = []
+    @usableFromInline
+    var regions: [UnsafeMutableRawPointer] = []
+    @usableFromInline
+    var current: Int = -1
+    @usableFromInline
+    var cursor: Int = 0
+    @usableFromInline
+    var limit: Int = 0
+
+    // Chunks are aligned to a cache line, which covers the alignment of any
+    // ordinary Swift type without padding at the start of each chunk.
+    static let chunkAlignment = 64
+
+    public init(_ pool: MemoryPool, chunkSize: Int = 64 * 1024, callstack: Int32 = 0) {
+        precondition(chunkSize > 0, "chunk size must be positive")
+        self.pool = pool
+        self.chunkSize = chunkSize
+        self.callstack = callstack
+    }
+
+    deinit {
+        releaseRegions()
+        for chunk in chunks {
+            chunk.base.deallocate()
+        }
+    }
+
+    /// Allocate an uninitialised region of `byteCount` bytes with the given
+    /// alignment. The region remains valid until the arena is reset or
+    /// destroyed.
+    @inlinable
+    public func allocate(byteCount: Int, alignment: Int = MemoryLayout<Int>.alignment) -> UnsafeMutableRawPointer {
+        precondition(byteCount >= 0, "byte count must not be negative")
+        precondition(alignment > 0 && alignment & (alignment - 1) == 0, "alignment must be a power of two")
+        let start = (cursor + alignment - 1) & ~(alignment - 1)
+        if current >= 0, start + byteCount <= limit {
+            cursor = start + byteCount
+            return report(UnsafeMutableRawPointer(bitPattern: start).unsafelyUnwrapped, byteCount: byteCount)
+        }
+        return allocateSlow(byteCount: byteCount, alignment: alignment)
+    }
+
+    /// Allocate uninitialised memory for `capacity` instances of `type`.
+    @inlinable
+    public func allocate<T>(_: T.Type, capacity: Int) -> UnsafeMutablePointer<T> {
+        allocate(byteCount: MemoryLayout<T>.stride * capacity, alignment: MemoryLayout<T>.alignment)
+            .bindMemory(to: T.self, capacity: capacity)
+    }
+
+    /// Rewind the arena, invalidating every region handed out so far. The
+    /// chunks are retained and reused by subsequent allocations.
+    public func reset() {
+        releaseRegions()
+        current = -1
+        cursor = 0
+        limit = 0
+    }
+
+    /// The total number of bytes reserved by the arena.
+    public var reservedBytes: Int {
+        chunks.reduce(0) { $0 + $1.size }
+    }
+
+    // Move to the next retained chunk which can satisfy the request, or
+    // reserve a new one if there is none.
+    @usableFromInline
+    func allocateSlow(byteCount: Int, alignment: Int) -> UnsafeMutableRawPointer {
+        let required = byteCount + max(0, alignment - Arena.chunkAlignment)
+        var next = current + 1
+        while next < chunks.count, chunks[next].size < required {
+            next += 1
+        }
+        if next == chunks.count {
+            let size = max(chunkSize, required)
+            let base = UnsafeMutableRawPointer.allocate(byteCount: size, alignment: Arena.chunkAlignment)
+            chunks.append(Chunk(base: base, size: size))
+        }
+
+        let chunk = chunks[next]
+        let base = Int(bitPattern: chunk.base)
+        let start = (base + alignment - 1) & ~(alignment - 1)
+        current = next
+        cursor = start + byteCount
+        limit = base + chunk.size
+        return report(UnsafeMutableRawPointer(bitPattern: start).unsafelyUnwrapped, byteCount: byteCount)
+    }
+
+    // Empty regions share their address with the next region, so are not
+    // reported; Tracy requires each live allocation to have a unique address.
+    @inlinable
+    @inline(__always)
+    func report(_ ptr: UnsafeMutableRawPointer, byteCount: Int) -> UnsafeMutableRawPointer {
+        #if SWIFT_TRACY_ENABLE
+        if byteCount > 0 {
+            pool.alloc(ptr, size: byteCount, callstack: callstack)
+            regions.append(ptr)
+        }
+        #endif
+        return ptr
+    }
+
+    func releaseRegions() {
+        for region in regions {
+            pool.free(region, callstack: callstack)
+        }
+        regions.removeAll(keepingCapacity: true)
+    }
+}
@@ -0,0 +1,146 @@
+// Copyright (c) 2026 The swift-tracy authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import Dispatch
+import TracyC
+
+// Instrumentation of Swift Concurrency scheduling. There are two (opt-in)
+// parts to this:
+//
+// 1. TaskTracing.install() hooks into the concurrency runtime so that every
+//    task which becomes runnable on the global or main executor, either
+//    because it was created or because it resumed after a suspension, is
+//    reported in the trace. Each enqueue adds a point to the "task enqueued",
+//    "task delayed" or "task enqueued on main" plot, whose value is the task
+//    ID. In addition, tasks on the global executor are run through a
+//    trampoline, so that:
+//
+//    - the time each task spent waiting for a thread of the global executor
+//      is recorded in the "task queue delay (ns)" plot, which shows when the
+//      cooperative pool is starved
+//    - each time the task runs (until it next suspends or completes) is a
+//      zone named "task" whose value is the task ID
+//
+//    The runtime does not say whether a run ended because the task suspended
+//    or completed. Tasks resuming after Task.sleep are reported as delayed and
+//    then enqueued again. Jobs on the main executor are only plotted.
+//
+// 2. TracingTaskExecutor additionally reports the creation and completion of
+//    tasks started with TracingTaskExecutor.task(priority:operation:). This
+//    executor runs its jobs on a concurrent dispatch queue rather than the
+//    cooperative thread pool, and measures its own queue instead. For tasks on
+//    this executor:
+//
+//    - each run is a zone and each queueing delay a point in the
+//      "task queue delay (ns)" plot, as for the global executor
+//    - the end of each run is a point in either the "task suspended" or the
+//      "task completed" plot, and the first enqueue of a new task is a point in
+//      the "task created" plot, with the task ID as the value
+//
+//    The runtime does not tell the executor whether a job is new or whether
+//    it completed, so the last point only applies to tasks started with
+//    TracingTaskExecutor.task(priority:operation:), which report both. The
+//    final run of any other task is reported as a suspension.
+
+public enum TaskTracing {
+    /// Install hooks into the Swift concurrency runtime. Returns whether the
+    /// hooks could be installed, which requires the concurrency runtime to be
+    /// dynamically loaded.
+    @discardableResult
+    public static func install() -> Bool {
+        #if SWIFT_TRACY_ENABLE
+        return ___tracy_swift_concurrency_install() != 0
+        #else
+        return false
+        #endif
+    }
+}
+
+// Use with 'task(priority:operation:)', or with 'withTaskExecutorPreference'
+// and 'Task(executorPreference:)' for tasks which do not need to report their
+// creation and completion.
+@available(macOS 15.0, *)
+public final class TracingTaskExecutor: TaskExecutor {
+    let queue: DispatchQueue
+
+    public init(label: String = "swift-tracy.task-executor", qos: DispatchQoS = .default) {
+        self.queue = DispatchQueue(label: label, qos: qos, attributes: .concurrent)
+    }
+
+    /// Create a task which runs on this executor, and reports when it was
+    /// created and when it completed in addition to each time it runs.
+    @discardableResult
+    public func task<Success: Sendable>(
+        priority: TaskPriority? = nil,
+        operation: @escaping @Sendable () async -> Success
+    ) -> Task<Success, Never> {
+        #if SWIFT_TRACY_ENABLE
+        ___tracy_swift_mark_task_created()
+        defer { _ = ___tracy_swift_take_task_created() }
+        #endif
+        return Task(executorPreference: self, priority: priority) {
+            let result = await operation()
+            #if SWIFT_TRACY_ENABLE
+            ___tracy_swift_mark_task_completed()
+            #endif
+            return result
+        }
+    }
+
+    public func enqueue(_ job: consuming ExecutorJob) {
+        let job = UnownedJob(job)
+        let enqueued = DispatchTime.now().uptimeNanoseconds
+
+        #if SWIFT_TRACY_ENABLE
+        if ___tracy_swift_take_task_created() != 0 {
+            plot("task created", TracingTaskExecutor.id(of: job))
+        }
+        #endif
+
+        queue.async {
+            self.run(job, enqueued: enqueued)
+        }
+    }
+
+    func run(_ job: UnownedJob, enqueued: UInt64) {
+        plot("task queue delay (ns)", Int(DispatchTime.now().uptimeNanoseconds - enqueued))
+
+        // The job may be destroyed once it has run, so read its ID up front
+        #if SWIFT_TRACY_ENABLE
+        let id = TracingTaskExecutor.id(of: job)
+        #endif
+
+        let z = #ZoneScoped(colour: 0x8899aa)
+        #if SWIFT_TRACY_ENABLE
+        z.value(id)
+        #endif
+        job.runSynchronously(on: asUnownedTaskExecutor())
+        z.end()
+
+        #if SWIFT_TRACY_ENABLE
+        if ___tracy_swift_take_task_completed() != 0 {
+            plot("task completed", id)
+        }
+        else {
+            plot("task suspended", id)
+        }
+        #endif
+    }
+
+    #if SWIFT_TRACY_ENABLE
+    static func id(of job: UnownedJob) -> Int {
+        Int(___tracy_swift_job_id(unsafeBitCast(job, to: UnsafeRawPointer.self)))
+    }
+    #endif
+}
@@ -0,0 +1,61 @@
+// Copyright (c) 2026 The swift-tracy authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import TracyC
+
+// Allocations made through malloc and friends are tracked automatically by the
+// interposition layer and all end up in Tracy's default memory pool. Custom
+// allocators (arenas, object pools, etc.) which carve up memory themselves can
+// report what they hand out to a separate, named pool instead, so that each
+// subsystem appears as its own entry in the Memory panel of the profiler.
+//
+// Tracy identifies a pool by the address of its name, not by the string
+// contents, so the name must be a StaticString. Identical string literals are
+// not guaranteed to share an address (particularly across modules), so define
+// each MemoryPool once and share that value between everything which reports
+// to the pool, rather than constructing it again from the same text.
+//
+// Every pointer reported with alloc() must later be reported with free() to
+// the same pool, otherwise it will show up as a leak.
+public struct MemoryPool: Sendable {
+    @usableFromInline
+    let name: StaticString
+
+    @inlinable
+    @inline(__always)
+    public init(_ name: StaticString) {
+        self.name = name
+    }
+
+    /// Report that the memory region starting at `ptr` of `size` bytes has
+    /// been handed out from this pool. Optionally collect the callstack of the
+    /// given depth.
+    @inlinable
+    @inline(__always)
+    public func alloc(_ ptr: UnsafeRawPointer, size: Int, callstack: Int32 = 0) {
+        #if SWIFT_TRACY_ENABLE
+        ___tracy_emit_memory_alloc_callstack_named(ptr, size, callstack, 0, name.utf8Start)
+        #endif
+    }
+
+    /// Report that the memory region starting at `ptr` has been returned to
+    /// this pool.
+    @inlinable
+    @inline(__always)
+    public func free(_ ptr: UnsafeRawPointer, callstack: Int32 = 0) {
+        #if SWIFT_TRACY_ENABLE
+        ___tracy_emit_memory_free_callstack_named(ptr, callstack, 0, name.utf8Start)
+        #endif
+    }
+}
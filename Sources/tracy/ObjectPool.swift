@@ -0,0 +1,92 @@
+// Copyright (c) 2026 The swift-tracy authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// A pool of fixed-size objects which reports every object it hands out to a
+// named MemoryPool.
+//
+// Storage is reserved in slabs of `slabCapacity` elements and never returned to
+// the system until the pool itself is destroyed. Released objects go on a free
+// list and are handed out again by the next acquire(), so the Memory panel
+// shows both how many objects are live and how often the same addresses get
+// reused.
+//
+// The pool only manages storage: objects are returned uninitialised from
+// acquire(), and must be deinitialised by the caller before release(). An
+// object pool is not thread safe.
+public final class ObjectPool<Element> {
+    public let pool: MemoryPool
+    public let slabCapacity: Int
+
+    @usableFromInline
+    let callstack: Int32
+    var slabs: [UnsafeMutablePointer<Element>] = []
+    @usableFromInline
+    var freeList: [UnsafeMutablePointer<Element>] = []
+
+    public init(_ pool: MemoryPool, slabCapacity: Int = 64, callstack: Int32 = 0) {
+        precondition(slabCapacity > 0, "slab capacity must be positive")
+        self.pool = pool
+        self.slabCapacity = slabCapacity
+        self.callstack = callstack
+    }
+
+    // Objects which are still checked out at this point are left reported as
+    // allocated, so they show up as leaks in the profiler.
+    deinit {
+        for slab in slabs {
+            slab.deallocate()
+        }
+    }
+
+    /// Take an object from the pool. The returned memory is uninitialised.
+    @inlinable
+    public func acquire() -> UnsafeMutablePointer<Element> {
+        if freeList.isEmpty {
+            grow()
+        }
+        let ptr = freeList.removeLast()
+        pool.alloc(ptr, size: MemoryLayout<Element>.stride, callstack: callstack)
+        return ptr
+    }
+
+    /// Return an object to the pool. The object must have been acquired from
+    /// this pool and already been deinitialised.
+    @inlinable
+    public func release(_ ptr: UnsafeMutablePointer<Element>) {
+        pool.free(ptr, callstack: callstack)
+        freeList.append(ptr)
+    }
+
+    /// The number of objects currently available without reserving a new slab.
+    public var available: Int {
+        freeList.count
+    }
+
+    /// The total number of objects the pool has storage for.
+    public var capacity: Int {
+        slabs.count * slabCapacity
+    }
+
+    // Reserve another slab and push its elements onto the free list in reverse,
+    // so that they are handed out in address order.
+    @usableFromInline
+    func grow() {
+        let slab = UnsafeMutablePointer<Element>.allocate(capacity: slabCapacity)
+        slabs.append(slab)
+        freeList.reserveCapacity(capacity)
+        for i in (0 ..< slabCapacity).reversed() {
+            freeList.append(slab + i)
+        }
+    }
+}
@@ -0,0 +1,44 @@
+// Copyright (c) 2026 The swift-tracy authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import TracyC
+
+// Plots track the value of some variable over time, such as the number of
+// objects in a queue or the latency of a request, and are displayed as graphs
+// in the timeline. As with memory pools, plots are identified by the address of
+// their name, so it must be a StaticString.
+
+@inlinable
+@inline(__always)
+public func plot(_ name: StaticString, _ value: Double) {
+    #if SWIFT_TRACY_ENABLE
+    ___tracy_emit_plot(name.utf8Start, value)
+    #endif
+}
+
+@inlinable
+@inline(__always)
+public func plot(_ name: StaticString, _ value: Float) {
+    #if SWIFT_TRACY_ENABLE
+    ___tracy_emit_plot_float(name.utf8Start, value)
+    #endif
+}
+
+@inlinable
+@inline(__always)
+public func plot(_ name: StaticString, _ value: Int) {
+    #if SWIFT_TRACY_ENABLE
+    ___tracy_emit_plot_int(name.utf8Start, Int64(value))
+    #endif
+}
@@ -26,20 +26,35 @@
 // depth of the callstack to capture. See the Tracy manual for further
 // information regarding callstack collection.
 //
-// As there is no automatic destruction mechanism, you must manually mark where
-// the zone ends.
+// The #Zone macro returns a Zone, which you must manually mark where it ends.
+// Alternatively, the #ZoneScoped macro takes the same arguments and returns a
+// non-copyable ScopedZone, which ends automatically when it is destroyed. Pass
+// it to withZone to measure a closure, or bind it to a variable and call end()
+// at the end of the scope. Note that a binding which is otherwise never used
+// will be diagnosed as such, and the suggested fix, '_ = #ZoneScoped', would end
+// the zone immediately.
 //
-// NOTE: This seems to require Swift 6 (-dev) in order to extract the function name
+// A zone which is literally 'active: false' does not call into Tracy at all. Its
+// methods check whether the zone is active before calling into Tracy, which the
+// compiler folds away for such a zone.
 //
-// XXX: The amount of duplication here is quite annoying...
+// NOTE: This seems to require Swift 6 (-dev) in order to extract the function name
 #if SWIFT_TRACY_ENABLE
 @freestanding(expression)
 public macro Zone(name: StaticString = .init(), colour: UInt32 = 0, callstack: Int32 = 0, active: Bool = true) -> Zone =
     #externalMacro(module: "TracyMacros", type: "Zone")
+
+@freestanding(expression)
+public macro ZoneScoped(name: StaticString = .init(), colour: UInt32 = 0, callstack: Int32 = 0, active: Bool = true) -> ScopedZone =
+    #externalMacro(module: "TracyMacros", type: "ZoneScoped")
 #else
 @freestanding(expression)
 public macro Zone(name: StaticString = .init(), colour: UInt32 = 0, callstack: Int32 = 0, active: Bool = true) -> Zone =
     #externalMacro(module: "TracyMacros", type: "ZoneDisabled")
+
+@freestanding(expression)
+public macro ZoneScoped(name: StaticString = .init(), colour: UInt32 = 0, callstack: Int32 = 0, active: Bool = true) -> ScopedZone =
+    #externalMacro(module: "TracyMacros", type: "ZoneScopedDisabled")
 #endif
 
 public struct Zone {
@@ -92,7 +107,9 @@ public struct Zone {
     @inline(__always)
     public func name(_ name: String) {
         #if SWIFT_TRACY_ENABLE
-        ___tracy_emit_zone_name(self.ctx, name, name.count)
+        if self.ctx.active != 0 {
+            ___tracy_emit_zone_name(self.ctx, name, name.count)
+        }
         #endif
     }
 
@@ -100,7 +117,9 @@ public struct Zone {
     @inline(__always)
     public func text(_ msg: String) {
         #if SWIFT_TRACY_ENABLE
-        ___tracy_emit_zone_text(self.ctx, msg, msg.count)
+        if self.ctx.active != 0 {
+            ___tracy_emit_zone_text(self.ctx, msg, msg.count)
+        }
         #endif
     }
 
@@ -108,7 +127,9 @@ public struct Zone {
     @inline(__always)
     public func value(_ val: Int) {
         #if SWIFT_TRACY_ENABLE
-        ___tracy_emit_zone_value(self.ctx, UInt64(val))
+        if self.ctx.active != 0 {
+            ___tracy_emit_zone_value(self.ctx, UInt64(val))
+        }
         #endif
     }
 
@@ -116,7 +137,9 @@ public struct Zone {
     @inline(__always)
     public func colour(_ colour: UInt32) {
         #if SWIFT_TRACY_ENABLE
-        ___tracy_emit_zone_color(self.ctx, colour)
+        if self.ctx.active != 0 {
+            ___tracy_emit_zone_color(self.ctx, colour)
+        }
         #endif
     }
 
@@ -124,7 +147,95 @@ public struct Zone {
     @inline(__always)
     public func end() {
         #if SWIFT_TRACY_ENABLE
-        ___tracy_emit_zone_end(self.ctx)
+        if self.ctx.active != 0 {
+            ___tracy_emit_zone_end_active(self.ctx)
+        }
+        #endif
+    }
+}
+
+// A zone which ends automatically when it is destroyed. Being non-copyable, it
+// can not be ended more than once.
+public struct ScopedZone: ~Copyable {
+    #if SWIFT_TRACY_ENABLE
+    @usableFromInline
+    let ctx: TracyCZoneCtx
+    #endif
+
+    @inlinable
+    @inline(__always)
+    public init(with context: TracyCZoneCtx) {
+        #if SWIFT_TRACY_ENABLE
+        self.ctx = context
+        #endif
+    }
+
+    @inlinable
+    deinit {
+        #if SWIFT_TRACY_ENABLE
+        if self.ctx.active != 0 {
+            ___tracy_emit_zone_end_active(self.ctx)
+        }
+        #endif
+    }
+
+    // End the zone now, rather than when it goes out of scope
+    @inlinable
+    @inline(__always)
+    public consuming func end() {
+        // consuming self destroys it on return, which runs the deinit
+    }
+
+    @inlinable
+    @inline(__always)
+    public func name(_ name: String) {
+        #if SWIFT_TRACY_ENABLE
+        if self.ctx.active != 0 {
+            ___tracy_emit_zone_name(self.ctx, name, name.count)
+        }
+        #endif
+    }
+
+    @inlinable
+    @inline(__always)
+    public func text(_ msg: String) {
+        #if SWIFT_TRACY_ENABLE
+        if self.ctx.active != 0 {
+            ___tracy_emit_zone_text(self.ctx, msg, msg.count)
+        }
         #endif
     }
+
+    @inlinable
+    @inline(__always)
+    public func value(_ val: Int) {
+        #if SWIFT_TRACY_ENABLE
+        if self.ctx.active != 0 {
+            ___tracy_emit_zone_value(self.ctx, UInt64(val))
+        }
+        #endif
+    }
+
+    @inlinable
+    @inline(__always)
+    public func colour(_ colour: UInt32) {
+        #if SWIFT_TRACY_ENABLE
+        if self.ctx.active != 0 {
+            ___tracy_emit_zone_color(self.ctx, colour)
+        }
+        #endif
+    }
+}
+
+// Measure the given closure as a zone, for example:
+//
+// > let sum = withZone(#ZoneScoped(name: "sum")) {
+// >     values.reduce(0, +)
+// > }
+@inlinable
+@inline(__always)
+public func withZone<Result>(_ zone: consuming ScopedZone, _ body: () throws -> Result) rethrows -> Result {
+    let result = try body()
+    zone.end()
+    return result
 }
@@ -0,0 +1,194 @@
+// Copyright (c) 2026 The swift-tracy authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Tests that the #Zone and #ZoneScoped macros pick the expected Tracy entry
+// point for their 'active:' and 'callstack:' arguments.
+//
+// The macros are expanded in a 'return' statement rather than bound with 'let',
+// since a pattern binding would become the lexical context used for the
+// function name.
+
+import SwiftSyntaxMacrosGenericTestSupport
+import Testing
+import TracyMacros
+
+private let macros: [String: MacroSpec] = [
+    "Zone": MacroSpec(type: Zone.self),
+    "ZoneScoped": MacroSpec(type: ZoneScoped.self),
+]
+
+private func assertZoneExpansion(
+    _ source: String,
+    expandedSource: String,
+    fileID: StaticString = #fileID,
+    filePath: StaticString = #filePath,
+    line: UInt = #line,
+    column: UInt = #column
+) {
+    assertMacroExpansion(
+        source,
+        expandedSource: expandedSource,
+        macroSpecs: macros,
+        failureHandler: { failure in
+            Issue.record(
+                Comment(rawValue: failure.message),
+                sourceLocation: Testing.SourceLocation(
+                    fileID: failure.location.fileID,
+                    filePath: failure.location.filePath,
+                    line: failure.location.line,
+                    column: failure.location.column
+                )
+            )
+        },
+        fileID: fileID,
+        filePath: filePath,
+        line: line,
+        column: column
+    )
+}
+
+@Suite("Zone macro expansion")
+struct ZoneMacroTests {
+    @Test("literal 'active: false' does not call into Tracy")
+    func inactive() {
+        assertZoneExpansion(
+            """
+            func foo() -> Zone {
+                return #Zone(name: "foo", active: false)
+            }
+            """,
+            expandedSource: """
+            func foo() -> Zone {
+                return Tracy.Zone.init(with: ___tracy_c_zone_context(id: 0, active: 0))
+            }
+            """
+        )
+    }
+
+    @Test("literal 'callstack: 0' does not collect the callstack")
+    func noCallstack() {
+        assertZoneExpansion(
+            """
+            func foo() -> Zone {
+                return #Zone(colour: 0x44aaff, callstack: 0)
+            }
+            """,
+            expandedSource: """
+            func foo() -> Zone {
+                return {
+                    struct __macro_local_3locfMu_ {
+                        @exclusivity(unchecked)
+                        nonisolated(unsafe)
+                        static var data = ___tracy_source_location_data(
+                            name: nil,
+                            function: StaticString(stringLiteral: "foo()").utf8Start,
+                            file: StaticString(stringLiteral: #file).utf8Start,
+                            line: #line,
+                            color: 0x44aaff)
+                        }
+                    let __macro_local_3ctxfMu_ = ___tracy_emit_zone_begin_active(&__macro_local_3locfMu_.data)
+                    return Tracy.Zone.init(with: __macro_local_3ctxfMu_)
+                }()
+            }
+            """
+        )
+    }
+
+    @Test("literal callstack depth")
+    func callstack() {
+        assertZoneExpansion(
+            """
+            func foo() -> Zone {
+                return #Zone(callstack: 8)
+            }
+            """,
+            expandedSource: """
+            func foo() -> Zone {
+                return {
+                    struct __macro_local_3locfMu_ {
+                        @exclusivity(unchecked)
+                        nonisolated(unsafe)
+                        static var data = ___tracy_source_location_data(
+                            name: nil,
+                            function: StaticString(stringLiteral: "foo()").utf8Start,
+                            file: StaticString(stringLiteral: #file).utf8Start,
+                            line: #line,
+                            color: 0)
+                        }
+                    let __macro_local_3ctxfMu_ = ___tracy_emit_zone_begin_callstack_active(&__macro_local_3locfMu_.data, 8)
+                    return Tracy.Zone.init(with: __macro_local_3ctxfMu_)
+                }()
+            }
+            """
+        )
+    }
+
+    @Test("non-literal 'active' is checked at runtime")
+    func runtimeActive() {
+        assertZoneExpansion(
+            """
+            func foo(enabled: Bool) -> Zone {
+                return #Zone(active: enabled)
+            }
+            """,
+            expandedSource: """
+            func foo(enabled: Bool) -> Zone {
+                return {
+                    struct __macro_local_3locfMu_ {
+                        @exclusivity(unchecked)
+                        nonisolated(unsafe)
+                        static var data = ___tracy_source_location_data(
+                            name: nil,
+                            function: StaticString(stringLiteral: "foo(enabled:)").utf8Start,
+                            file: StaticString(stringLiteral: #file).utf8Start,
+                            line: #line,
+                            color: 0)
+                        }
+                    let __macro_local_3ctxfMu_ = ___tracy_emit_zone_begin(&__macro_local_3locfMu_.data, enabled ? 1 : 0)
+                    return Tracy.Zone.init(with: __macro_local_3ctxfMu_)
+                }()
+            }
+            """
+        )
+    }
+
+    @Test("#ZoneScoped returns a ScopedZone")
+    func scoped() {
+        assertZoneExpansion(
+            """
+            func foo() -> ScopedZone {
+                return #ZoneScoped
+            }
+            """,
+            expandedSource: """
+            func foo() -> ScopedZone {
+                return {
+                    struct __macro_local_3locfMu_ {
+                        @exclusivity(unchecked)
+                        nonisolated(unsafe)
+                        static var data = ___tracy_source_location_data(
+                            name: nil,
+                            function: StaticString(stringLiteral: "foo()").utf8Start,
+                            file: StaticString(stringLiteral: #file).utf8Start,
+                            line: #line,
+                            color: 0)
+                        }
+                    let __macro_local_3ctxfMu_ = ___tracy_emit_zone_begin_active(&__macro_local_3locfMu_.data)
+                    return Tracy.ScopedZone.init(with: __macro_local_3ctxfMu_)
+                }()
+            }
+            """
+        )
+    }
+}
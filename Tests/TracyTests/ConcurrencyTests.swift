@@ -0,0 +1,79 @@
+// Copyright (c) 2026 The swift-tracy authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Tests that tasks still run correctly once the concurrency hooks are
+// installed, since these take over enqueueing jobs on the global executor.
+//
+// As with the allocator tests, these do NOT verify that Tracy records the task
+// events (that requires a running Tracy server and is validated manually via
+// the demo executable).
+//
+// Run with: SWIFT_TRACY_ENABLE=true swift test
+
+import Testing
+import Tracy
+
+@Suite("Swift Concurrency instrumentation")
+struct ConcurrencyTests {
+
+    @Test func installReportsHooks() {
+        #if SWIFT_TRACY_ENABLE
+        #expect(TaskTracing.install())
+        #else
+        #expect(!TaskTracing.install())
+        #endif
+    }
+
+    @Test func tasksComplete() async {
+        TaskTracing.install()
+        let sum = await withTaskGroup(of: Int.self) { group in
+            for i in 0 ..< 1000 {
+                group.addTask {
+                    await Task.yield()
+                    return i
+                }
+            }
+            return await group.reduce(0, +)
+        }
+        #expect(sum == 499500)
+    }
+
+    @available(macOS 13.0, *)
+    @Test func sleepingTasksComplete() async throws {
+        TaskTracing.install()
+        let clock = ContinuousClock()
+        let start = clock.now
+        try await Task.sleep(for: .milliseconds(10))
+        #expect(clock.now - start >= .milliseconds(10))
+    }
+
+    @Test func mainActorHopsComplete() async {
+        TaskTracing.install()
+        var total = 0
+        for i in 0 ..< 10 {
+            total += await MainActor.run { i }
+        }
+        #expect(total == 45)
+    }
+
+    @available(macOS 15.0, *)
+    @Test func tracingExecutorReturnsResult() async {
+        let executor = TracingTaskExecutor()
+        let result = await executor.task {
+            await Task.yield()
+            return 42
+        }.value
+        #expect(result == 42)
+    }
+}
@@ -0,0 +1,132 @@
+// Copyright (c) 2026 The swift-tracy authors. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Tests that the instrumented allocators behave correctly as allocators.
+//
+// As with the interposition tests, these do NOT verify that Tracy records the
+// named pool events (that requires a running Tracy server and is validated
+// manually via the demo executable).
+//
+// Run with: SWIFT_TRACY_ENABLE=true swift test
+
+import Testing
+@testable import Tracy
+
+// Pools are identified by the address of their name, so define each one once.
+private let arenaPool = MemoryPool("test arena")
+private let objectPool = MemoryPool("test objects")
+
+@Suite("Instrumented allocators")
+struct MemoryPoolTests {
+
+    // MARK: Arena
+
+    @Test func arenaRespectsAlignment() {
+        let arena = Arena(arenaPool, chunkSize: 256)
+        for alignment in [1, 2, 4, 8, 16, 32, 64, 128] {
+            _ = arena.allocate(byteCount: 3, alignment: 1)
+            let ptr = arena.allocate(byteCount: 8, alignment: alignment)
+            #expect(Int(bitPattern: ptr) % alignment == 0, "arena result not \(alignment)-byte aligned")
+        }
+    }
+
+    @Test func arenaRegionsDoNotOverlap() {
+        let arena = Arena(arenaPool, chunkSize: 128)
+        var regions: [UnsafeMutablePointer<UInt32>] = []
+        for i in 0 ..< 100 {
+            let ptr = arena.allocate(UInt32.self, capacity: 4)
+            ptr.initialize(repeating: UInt32(i), count: 4)
+            regions.append(ptr)
+        }
+        for (i, ptr) in regions.enumerated() {
+            for j in 0 ..< 4 {
+                #expect(ptr[j] == UInt32(i), "arena region \(i) was overwritten")
+            }
+        }
+    }
+
+    @Test func arenaOversizedRequest() {
+        let arena = Arena(arenaPool, chunkSize: 64)
+        let ptr = arena.allocate(byteCount: 1000, alignment: 8)
+        ptr.initializeMemory(as: UInt8.self, repeating: 0xab, count: 1000)
+        #expect(arena.reservedBytes >= 1000)
+    }
+
+    @Test func arenaResetReusesChunks() {
+        let arena = Arena(arenaPool, chunkSize: 256)
+        let first = arena.allocate(byteCount: 200)
+        _ = arena.allocate(byteCount: 200)
+        let reserved = arena.reservedBytes
+
+        arena.reset()
+        #expect(arena.allocate(byteCount: 200) == first)
+        _ = arena.allocate(byteCount: 200)
+        #expect(arena.reservedBytes == reserved)
+    }
+
+    @Test func arenaResetReleasesRegions() {
+        let arena = Arena(arenaPool, chunkSize: 256)
+        var regions: [UnsafeMutableRawPointer] = []
+        for _ in 0 ..< 8 {
+            regions.append(arena.allocate(byteCount: 48))
+        }
+        _ = arena.allocate(byteCount: 0)
+        #if SWIFT_TRACY_ENABLE
+        #expect(arena.regions == regions, "empty regions should not be reported")
+        #endif
+
+        arena.reset()
+        #if SWIFT_TRACY_ENABLE
+        #expect(arena.regions.isEmpty)
+        #endif
+
+        // The next round reports the same addresses again
+        for region in regions {
+            #expect(arena.allocate(byteCount: 48) == region)
+        }
+        #if SWIFT_TRACY_ENABLE
+        #expect(arena.regions == regions)
+        #endif
+    }
+
+    // MARK: ObjectPool
+
+    @Test func objectPoolRecyclesObjects() {
+        let pool = ObjectPool<Int>(objectPool, slabCapacity: 4)
+        let a = pool.acquire()
+        a.initialize(to: 42)
+        a.deinitialize(count: 1)
+        pool.release(a)
+        #expect(pool.acquire() == a)
+    }
+
+    @Test func objectPoolGrowsBySlab() {
+        let pool = ObjectPool<Int>(objectPool, slabCapacity: 4)
+        var objects: [UnsafeMutablePointer<Int>] = []
+        for i in 0 ..< 10 {
+            let ptr = pool.acquire()
+            ptr.initialize(to: i)
+            objects.append(ptr)
+        }
+        #expect(pool.capacity == 12)
+        #expect(pool.available == 2)
+        #expect(Set(objects).count == objects.count)
+        for (i, ptr) in objects.enumerated() {
+            #expect(ptr.pointee == i)
+            ptr.deinitialize(count: 1)
+            pool.release(ptr)
+        }
+        #expect(pool.available == pool.capacity)
+    }
+}